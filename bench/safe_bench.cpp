@@ -0,0 +1,91 @@
+// Part of measurement-kit <https://measurement-kit.github.io/>.
+// Measurement-kit is free software under the BSD license. See AUTHORS
+// and LICENSE for more information on the copying conditions.
+
+// This microbenchmark measures the cost of dereferencing a `mk::Safe<>`
+// wrapped smart pointer with `operator*()`, `operator->()` and `get()`. As
+// `mk/safe.hpp` is header only, it only needs the `include` directory:
+//
+//     g++ -std=c++14 -O2 -Iinclude bench/safe_bench.cpp -o safe_bench
+//
+// Add `-DNDEBUG -DMK_SAFE_UNCHECKED` to measure the unchecked accessors. To
+// compare with another version of the header, point `-I` to the directory
+// containing it. The accessors are inlined into the timed loops, as they are
+// in real code, and optimization barriers force the compiler to reload the
+// wrapped pointer and to compute the result at each iteration, so that the
+// loops measure the load, the check and the dereference performed by the
+// accessor, rather than the cost of calling a function. The barriers are
+// only implemented for GCC and clang. With other compilers the compiler may
+// hoist the accessor out of the loop, making the results meaningless.
+
+#include <chrono>      // for std::chrono
+#include <cstdio>      // for std::printf
+#include <memory>      // for std::shared_ptr
+#include <mk/safe.hpp> // for mk::Safe
+#include <string>      // for std::string
+
+namespace {
+
+// The `clobber()` function tells the compiler that `p` may have been modified,
+// so that the wrapped pointer must be loaded again, and `keep()` tells it that
+// `value` is used, so that it must be computed.
+#if defined(__GNUC__)
+inline void clobber(const void *p) { asm volatile("" : : "g"(p) : "memory"); }
+inline void keep(int value) { asm volatile("" : : "r"(value)); }
+#else
+inline void clobber(const void *) {}
+inline void keep(int value) {
+    static volatile int sink = 0;
+    sink = value;
+}
+#endif
+
+// The pointee is large, so that copying it by mistake (e.g. if `operator*()`
+// returned by value) shows up in the results.
+struct Pointee {
+    std::string buffer = std::string(256, 'x');
+    int value = 1;
+};
+
+using SafePointee = mk::Safe<std::shared_ptr<Pointee>>;
+
+constexpr int iterations = 100000000;
+constexpr int repetitions = 7;
+
+// Returns the average number of nanoseconds per iteration of a loop that
+// calls `access` on `p`, which should be small enough to be inlined. The loop
+// is repeated a few times and the fastest repetition is used, since the other
+// ones are only slower because of noise (e.g. interrupts, frequency scaling).
+template <typename Access> double measure(const SafePointee &p, Access access) {
+    double fastest = 0.0;
+    for (int r = 0; r < repetitions; ++r) {
+        auto begin = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            clobber(&p);
+            keep(access(p));
+        }
+        auto end = std::chrono::steady_clock::now();
+        std::chrono::duration<double, std::nano> elapsed = end - begin;
+        double result = elapsed.count() / iterations;
+        if (r == 0 || result < fastest) {
+            fastest = result;
+        }
+    }
+    return fastest;
+}
+
+} // namespace
+
+int main() {
+    SafePointee p{std::make_shared<Pointee>()};
+    auto nothing = [](const SafePointee &) { return 1; };
+    auto deref = [](const SafePointee &q) { return (*q).value; };
+    auto arrow = [](const SafePointee &q) { return q->value; };
+    auto get = [](const SafePointee &q) { return q.get()->value; };
+    // The empty loop measures the cost of the loop and of the barriers, which
+    // should be subtracted from the other results.
+    std::printf("baseline:   %.3f ns/op\n", measure(p, nothing));
+    std::printf("operator*:  %.3f ns/op\n", measure(p, deref));
+    std::printf("operator->: %.3f ns/op\n", measure(p, arrow));
+    std::printf("get:        %.3f ns/op\n", measure(p, get));
+}
@@ -0,0 +1,116 @@
+// Part of measurement-kit <https://measurement-kit.github.io/>.
+// Measurement-kit is free software under the BSD license. See AUTHORS
+// and LICENSE for more information on the copying conditions.
+#ifndef MK_BOOTSTRAP_HPP
+#define MK_BOOTSTRAP_HPP
+
+// The `mk/bootstrap.hpp` header defines the `mk::BootstrapContext` class,
+// which allows many tests to share the results of the bootstrap steps
+// (i.e. bouncer query, IP lookup, GeoIP lookups and resolver lookup).
+
+#include <functional>    // for std::function
+#include <memory>        // for std::shared_ptr
+#include <mk/logger.hpp> // for mk::Logger
+#include <mk/safe.hpp>   // for mk::Safe
+#include <string>        // for std::string
+
+namespace mk {
+
+// ## The BootstrapContext class
+//
+// The `BootstrapContext` class caches the results of steps 3 through 13 of
+// the test sequence documented in `mk/nettests.hpp`. You can pass the same
+// context to many tests using `BaseTest::set_bootstrap_context()`. When a
+// test with a context starts, and the context is filled and not expired, the
+// test uses the cached results and skips the bouncer query, the IP lookup,
+// the GeoIP lookups and the resolver lookup. Otherwise, the test performs
+// such steps and stores their results into the context, for the benefit of
+// the subsequent tests. If many tests find the context empty or expired at
+// the same time, only one of them performs the bootstrap, while the others
+// wait for it to complete. Waiting is asynchronous: a waiting test does not
+// block the thread running it, so that, e.g., the I/O threads of a
+// `TestRunner` keep running other tests in the meanwhile.
+//
+// What is cached is the cleartext probe IP, ASN and CC, the resolver IP, and
+// the collector and test helpers returned by the bouncer. As the bouncer
+// returns test helpers that depend on the test, the bouncer is queried again
+// the first time a test with a different name uses the context, unless such
+// name was added using `add_test_name()`. Options that only concern a
+// specific test, e.g. `MK_OPT_SAVE_PROBE_IP` (steps 9-11) and
+// `MK_OPT_COLLECTOR_BASE_URL` (step 4), are always applied by each test to
+// its own copy of the cached results.
+//
+// Cached results are keyed on the values of the options that determine them,
+// i.e. `MK_OPT_NO_BOUNCER`, `MK_OPT_BOUNCER_BASE_URL`, `MK_OPT_NO_IP_LOOKUP`,
+// `MK_OPT_PROBE_IP`, `MK_OPT_PROBE_ASN`, `MK_OPT_PROBE_CC`,
+// `MK_OPT_GEOIP_COUNTRY_PATH`, `MK_OPT_GEOIP_ASN_PATH`,
+// `MK_OPT_NO_RESOLVER_LOOKUP`, `MK_OPT_DNS_ENGINE`,
+// `MK_OPT_DNS_NAMESERVER_HINT`, `MK_OPT_DNS_CACHE_UPSTREAM_ENGINE` and
+// `MK_OPT_CA_BUNDLE_PATH`. A test only uses the results obtained with the
+// same values of these options as its own. Otherwise, it performs the
+// bootstrap and stores its results into the context alongside the others. The
+// results filled by `run()` and `start()` are keyed on the options set with
+// `set_option()`. All the other options do not affect the cached results.
+//
+// Bootstrap failures are not cached. Hence a test that needs a failed step
+// will try again to perform that step.
+//
+// Copying a `BootstrapContext` yields another handle for the same shared
+// context. All methods of this class can be safely called concurrently
+// from multiple threads.
+//
+// ### Methods
+class BootstrapContext {
+  public:
+    // The default constructor creates an empty context that never expires.
+    BootstrapContext();
+
+    // The `set_ttl()` method sets the number of seconds after which the
+    // results cached in the context are considered expired. A negative or
+    // zero value means that the results never expire.
+    BootstrapContext &set_ttl(double seconds);
+
+    // The `set_option()` method sets the options to be used by `run()` and
+    // `start()`. The meaning is the same as for `BaseTest::set_option()`, and
+    // so is the handling of invalid values and unknown keys, but only options
+    // concerning steps 3 through 13 are considered. Other registered options
+    // are accepted and ignored, without any warning.
+    BootstrapContext &set_option(std::string key, std::string value);
+
+    // The `add_test_name()` method adds the OONI name of a test (e.g.
+    // `web_connectivity`) to the names for which the context is filled. When
+    // the bouncer is queried, the collector and test helpers for all such
+    // names are requested with a single query, so that the tests using these
+    // names do not need to query the bouncer again.
+    BootstrapContext &add_test_name(std::string test_name);
+
+    // The `set_logger()` method sets the logger to be used by `run()` and
+    // by `start()`.
+    BootstrapContext &set_logger(Logger logger);
+
+    // The `run()` method fills the context, blocking until done. You do not
+    // need to call this method, as the first test using the context will
+    // fill it. Yet, it allows you to pay the bootstrap cost in advance.
+    void run();
+
+    // The `start()` method fills the context in a background thread and
+    // calls the callback specified as argument when done.
+    void start(std::function<void()> &&cb);
+
+    // The `expired()` method returns whether the context contains no results
+    // for the options set with `set_option()`, or such results are older than
+    // the configured TTL.
+    bool expired() const;
+
+    // The `clear()` method removes all the cached results, regardless of the
+    // options they are keyed on, thus forcing the next test to perform the
+    // bootstrap again.
+    void clear();
+
+  private:
+    class Impl;
+    mk::Safe<std::shared_ptr<Impl>> impl_;
+};
+
+} // namespace mk
+#endif
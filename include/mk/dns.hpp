@@ -0,0 +1,58 @@
+// Part of measurement-kit <https://measurement-kit.github.io/>.
+// Measurement-kit is free software under the BSD license. See AUTHORS
+// and LICENSE for more information on the copying conditions.
+#ifndef MK_DNS_HPP
+#define MK_DNS_HPP
+
+// The `mk/dns.hpp` header defines functions to inspect and control the DNS
+// cache shared by all the tests using the `caching` DNS engine.
+
+#include <cstdint> // for uint64_t
+
+namespace mk {
+
+// ## The DNS cache
+//
+// When a test selects the `caching` engine using `MK_OPT_DNS_ENGINE`, its
+// queries are served by a cache that is shared by all the tests running in
+// the process. Queries not found in the cache are forwarded to the engine
+// specified with `MK_OPT_DNS_CACHE_UPSTREAM_ENGINE`, using the nameserver
+// specified with `MK_DNS_NAMESERVER_HINT`, if any. Answers are cached for as
+// long as allowed by their TTL, while failed queries are cached for
+// `MK_OPT_DNS_CACHE_NEGATIVE_TTL` seconds.
+//
+// Cached answers are keyed by upstream engine, nameserver hint, name and type,
+// so that a test never receives an answer obtained using another engine or
+// another nameserver. If a query with the same key is already in flight when
+// another test sends it, the second query is not sent and both tests will
+// receive the same answer.
+//
+// `DnsInjectionTest`, which needs to observe the answers sent by the network
+// to each of its queries, always bypasses the cache, even when configured to
+// use the `caching` engine. It is currently the only test that does so.
+//
+// The `DnsCacheStats` struct contains the counters of the DNS cache. The
+// `hits` field counts the queries answered from the cache, `negative_hits`
+// the queries answered with a cached failure, `misses` the queries that were
+// forwarded to the upstream engine, `coalesced` the queries that waited for
+// an identical query already in flight, and `entries` is the number of names
+// currently cached.
+struct DnsCacheStats {
+    uint64_t hits = 0;
+    uint64_t negative_hits = 0;
+    uint64_t misses = 0;
+    uint64_t coalesced = 0;
+    uint64_t entries = 0;
+};
+
+// The `dns_cache_stats()` function returns the current counters of the DNS
+// cache. Counters are updated atomically but are not read all at once, so
+// their values may be slightly inconsistent with each other.
+DnsCacheStats dns_cache_stats() noexcept;
+
+// The `dns_cache_clear()` function removes all the entries from the DNS
+// cache. Queries in flight are not affected.
+void dns_cache_clear() noexcept;
+
+} // namespace mk
+#endif
@@ -8,6 +8,7 @@
 // defines all the possible failure strings. These strings are compliant with
 // the [OONI specification](https://github.com/TheTorProject/ooni-spec/).
 
+#include <memory>      // for std::shared_ptr
 #include <mk/safe.hpp> // for mk::Safe
 #include <string>      // for std::string
 #include <utility>     // for std::move
@@ -38,31 +39,67 @@ namespace mk {
 // the `child_failures()` method; otherwise, predictably, such method would
 // return an empty vector.
 //
+// Creating and copying failures is cheap in the common cases. A failure
+// containing no error does not allocate any memory. A failure created from
+// one of the failure strings defined below (e.g. `MK_EOF_ERROR`) shares with
+// all the other failures created from the same string an immutable state
+// allocated once per process, so creating it does not allocate either. A
+// composite failure allocates its state once, and its child failures are
+// moved into it rather than copied.
+//
 // ### Methods
 class Failure {
   public:
     // The default constructor creates a failure containing no error. That is
     // to say that no failure has actually occurred.
-    Failure();
+    Failure() noexcept;
 
     // The constructor with failure string creates the failure corresponding
     // to the string specified as argument.
     Failure(std::string s);
 
+    // The constructor with C string is like the constructor with failure
+    // string, except that it does not copy the string when it is one of the
+    // failure strings defined below. If `s` is `nullptr`, the failure contains
+    // no error, as with the default constructor.
+    Failure(const char *s);
+
+    // The constructor with child failures creates a `composite_failure` whose
+    // child failures are the ones passed as argument. If `children` is empty,
+    // the failure contains no error, as with the default constructor, rather
+    // than being a `composite_failure` without children.
+    explicit Failure(std::vector<Failure> children);
+
     // The cast to `bool` operator returns `false` if no failure actually
     // occurred and `true` otherwise.
     operator bool() const noexcept;
 
     // The `reason()` method returns the failure string. In case no failure
-    // occurred, the string would actually be an empty string.
+    // occurred, the string would actually be an empty string. When the failure
+    // was created from one of the failure strings defined below, the returned
+    // string has static storage duration.
     const char *reason() const;
 
     // The `detailed_reason()` method returns the failure (including all
     // child failures) as a serialized JSON object. In case of no child
     // failures, a string is returned, just like `reason()`. In case there
-    // was no failure, an empty string would be returned.
+    // was no failure, an empty string would be returned. The serialization is
+    // computed the first time this method is called and then cached, so that
+    // subsequent calls, also on copies of this failure, are cheap. It is safe
+    // to call this method concurrently. The returned pointer remains valid as
+    // long as this failure, or any copy of it, is alive.
     const char *detailed_reason() const;
 
+    // The `append_detailed_reason()` method appends to `out` the failure as a
+    // complete JSON value, so that it can be embedded into a larger JSON
+    // document, e.g. as the value of the `failure` key of an entry. Such
+    // value is `null` in case there was no failure, the quoted and escaped
+    // failure string in case of no child failures, and the same JSON object
+    // that `detailed_reason()` would return for a composite failure. If such
+    // object has not been cached yet, it is written directly into `out`
+    // without caching it, thus avoiding to build the same JSON twice.
+    void append_detailed_reason(std::string &out) const;
+
     // The `child_failures()` method returns the child failures.
     const std::vector<Failure> &child_failures() const;
 
@@ -79,5 +116,13 @@ class Failure {
 
 #define MK_EOF_ERROR "eof_error"
 
+#define MK_CONNECTION_REFUSED_ERROR "connection_refused_error"
+
+#define MK_CONNECTION_RESET_ERROR "connection_reset_error"
+
+#define MK_DNS_LOOKUP_ERROR "dns_lookup_error"
+
+#define MK_COMPOSITE_FAILURE "composite_failure"
+
 } // namespace mk
 #endif
@@ -0,0 +1,64 @@
+// Part of measurement-kit <https://measurement-kit.github.io/>.
+// Measurement-kit is free software under the BSD license. See AUTHORS
+// and LICENSE for more information on the copying conditions.
+#ifndef MK_GEOIP_HPP
+#define MK_GEOIP_HPP
+
+// The `mk/geoip.hpp` header defines the `mk::GeoipDatabase` class, which
+// allows you to map IP addresses to country codes and ASNs.
+
+#include <memory>      // for std::shared_ptr
+#include <mk/safe.hpp> // for mk::Safe
+#include <string>      // for std::string
+
+namespace mk {
+
+// ## The GeoipDatabase class
+//
+// The `GeoipDatabase` class is a handle to a GeoIP database file. The file is
+// mapped in memory read-only the first time a handle for its path is created
+// and it is unmapped when the last handle referring to it is destroyed. All
+// the handles for the same path, including the ones used internally by tests
+// configured with `MK_OPT_GEOIP_COUNTRY_PATH` and `MK_OPT_GEOIP_ASN_PATH`,
+// share the same mapping. Therefore, running many tests in parallel does not
+// require loading many copies of the same database. Besides, you can keep
+// a handle alive to avoid mapping the database again for each test.
+//
+// Paths are compared literally, so `./asn.dat` and `asn.dat` are mapped
+// twice. If the file is replaced on disk, existing handles continue to use
+// the old mapping, while handles created after all the old handles have
+// been destroyed will map the new file.
+//
+// Copying a `GeoipDatabase` yields another handle for the same mapping. All
+// the lookup methods can be called concurrently from multiple threads.
+//
+// ### Methods
+class GeoipDatabase {
+  public:
+    // The constructor with path creates a handle for the database at the
+    // specified path. This constructor does not throw if the database cannot
+    // be opened, rather the handle will not be valid (see below).
+    GeoipDatabase(std::string path);
+
+    // The `is_valid()` method returns `true` if the database was opened and
+    // mapped successfully, and `false` otherwise.
+    bool is_valid() const noexcept;
+
+    // The `lookup_cc()` method returns the country code of `ip`. It returns
+    // `ZZ` if the handle is not valid, if this is not a country database, or
+    // if the address is not found in the database.
+    std::string lookup_cc(std::string ip) const;
+
+    // The `lookup_asn()` method returns the ASN of `ip`, formatted as `AS`
+    // followed by a number (e.g. `AS30722`). It returns `AS0` if the handle is
+    // not valid, if this is not an ASN database, or if the address is not
+    // found in the database.
+    std::string lookup_asn(std::string ip) const;
+
+  private:
+    class Impl;
+    mk::Safe<std::shared_ptr<Impl>> impl_;
+};
+
+} // namespace mk
+#endif
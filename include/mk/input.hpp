@@ -0,0 +1,54 @@
+// Part of measurement-kit <https://measurement-kit.github.io/>.
+// Measurement-kit is free software under the BSD license. See AUTHORS
+// and LICENSE for more information on the copying conditions.
+#ifndef MK_INPUT_HPP
+#define MK_INPUT_HPP
+
+// The `mk/input.hpp` header defines the `mk::InputFileReader` class, which
+// allows to lazily read the inputs of a test from a file.
+
+#include <memory>      // for std::shared_ptr
+#include <mk/safe.hpp> // for mk::Safe
+#include <string>      // for std::string
+
+namespace mk {
+
+// ## The InputFileReader class
+//
+// The `InputFileReader` class reads inputs from a file, one input per line,
+// by mapping the file in memory read-only. Lines are extracted from the
+// mapped file only when requested, therefore the memory used does not depend
+// on the number of inputs in the file. Leading and trailing whitespaces are
+// removed from each line, and empty lines are skipped.
+//
+// This class is a callable that can be passed to `BaseTest::set_input_source()`
+// and it is what measurement-kit uses internally to read the files specified
+// with `BaseTest::add_input_filepath()` and `BaseTest::set_input_filepath()`.
+//
+// Copying an `InputFileReader` yields another handle for the same reader,
+// sharing the same position within the file. A reader is not meant to be
+// used concurrently by multiple threads.
+//
+// ### Methods
+class InputFileReader {
+  public:
+    // The constructor with path creates a reader for the file at the
+    // specified path. This constructor does not throw if the file cannot be
+    // opened, rather the reader will not return any input.
+    InputFileReader(std::string path);
+
+    // The `is_valid()` method returns `true` if the file was opened and
+    // mapped successfully, and `false` otherwise.
+    bool is_valid() const noexcept;
+
+    // The function call operator stores the next input into `input` and
+    // returns `true`. If there are no more inputs, it returns `false`.
+    bool operator()(std::string &input);
+
+  private:
+    class Impl;
+    mk::Safe<std::shared_ptr<Impl>> impl_;
+};
+
+} // namespace mk
+#endif
@@ -7,6 +7,7 @@
 // The `mk/logger.hpp` file defines the `mk::Logger` class as well as the
 // macro defining the log severity.
 
+#include <cstddef>     // for size_t
 #include <cstdint>     // for uint32_t
 #include <functional>  // for std::function
 #include <memory>      // for std::unique_ptr
@@ -28,6 +29,20 @@
 
 namespace mk {
 
+// ## Compile time log level
+//
+// measurement-kit may be compiled with `MK_LOG_MAX_LEVEL` defined to one of
+// the log severity levels above (e.g. `-DMK_LOG_MAX_LEVEL=MK_LOG_INFO`). In
+// such case, the log statements of measurement-kit more verbose than this
+// level are removed at compile time and cost nothing at runtime, regardless
+// of the configured verbosity. This is a setting of the library build, hence
+// defining `MK_LOG_MAX_LEVEL` when compiling your code has no effect.
+//
+// The `log_max_level()` function returns the most verbose log severity level
+// compiled into the library, which is `MK_LOG_DEBUG2` by default. Setting a
+// verbosity greater than this value does not produce more log lines.
+uint32_t log_max_level() noexcept;
+
 // ## The Logger class
 //
 // The `Logger` class allows you to configure logging for running a
@@ -44,7 +59,10 @@ class Logger {
 
     [[deprecated]] uint32_t get_verbosity() const;
 
-    // The `verbosity()` method gets the configured verbosity.
+    // The `verbosity()` method gets the configured verbosity. This is a
+    // plain atomic load that never locks, so that it is cheap enough to be
+    // called before each log statement. Like all the other methods, it throws
+    // `std::runtime_error` if called on an empty (e.g. moved-from) logger.
     uint32_t verbosity() const;
 
     // The `on_log` method allows you to specify an handler function to be
@@ -69,12 +87,82 @@ class Logger {
     // function is the serialized JSON.
     Logger &on_event(std::function<void(const char *)> &&fn);
 
+    // The `on_event` method with data and length is like `on_event` except
+    // that the handler receives a pointer to the buffer where the event has
+    // been serialized and its length. This buffer is only valid until the
+    // handler returns and it is not guaranteed to be NUL terminated. If more
+    // than one event handler is set, the last one wins.
+    Logger &on_event(std::function<void(const char *, size_t)> &&fn);
+
     // The `on_progress()` method allows to set the progress handler.
     Logger &on_progress(std::function<void(double, const char *)> &&fn);
 
     // The `set_logfile()` method sets the file where to write logs.
     Logger &set_logfile(std::string fpath);
 
+    // The `set_async()` method controls how log lines are delivered. By
+    // default, a log line is formatted, written to the logfile, and passed to
+    // the `on_log` handler by the thread that emits it. If you set the logger
+    // to be async, instead, the emitting thread only formats the line into a
+    // lock-free per-thread queue, and a background thread writes it to the
+    // logfile and calls the `on_log` handler. Lines emitted by the same thread
+    // are delivered in order. When a queue is full, lines are dropped rather
+    // than blocking the emitting thread, and a warning line with the number
+    // of dropped lines is delivered as soon as there is space again.
+    //
+    // Likewise, when the logger is async, events and progress updates are
+    // delivered to the `on_event` and `on_progress` handlers by the same
+    // background thread, so that a slow handler never blocks the test. If a
+    // periodic event (i.e. `download-speed` and `upload-speed`) of the same
+    // type and stream (see the `stream` key of multi-stream tests), or a
+    // progress update, is still queued when a new one is emitted, the queued
+    // one is replaced by the new one, so that handlers always get the most
+    // recent information. Other events are never replaced.
+    //
+    // Unlike log lines and periodic events, events that cannot be replaced
+    // (e.g. `phase-complete`, `phase-summary` and `file-report-backpressure`)
+    // are never dropped. When the queue is full, such events, and only such
+    // events, are appended to a per-thread overflow list, which the background
+    // thread delivers, in order, before the events queued afterwards. In the
+    // meanwhile, log lines are still dropped and counted, and periodic events
+    // and progress updates are still replaced, as explained above. As tests
+    // only emit a few of such events per phase and per input, the overflow
+    // list cannot grow faster than the test itself progresses.
+    //
+    // When the test is done, the thread running it does not wait for the
+    // background thread to deliver its events. Rather, the `on_end()` callback
+    // is deferred, and then called by the thread running the test once all
+    // the events emitted by the test, including `phase-summary`, have been
+    // delivered. Hence, `on_end()` is always called after the event handler
+    // has received `phase-summary`, and a slow handler never blocks the thread
+    // running the test, and thus the other tests that run on such thread
+    // (e.g. when using a `TestRunner`).
+    Logger &set_async(bool enable);
+
+    // The `set_queue_size()` method sets the size in bytes of each per-thread
+    // queue used when the logger is async. The default is `65536`.
+    Logger &set_queue_size(size_t nbytes);
+
+    // The `set_max_event_rate()` method sets the maximum number of periodic
+    // events of each type (and of progress updates) delivered per second.
+    // Events emitted faster than this rate are coalesced: only the most recent
+    // event of each type and stream is delivered when the rate allows it. The
+    // last of such events emitted by a test is always delivered before the
+    // test ends. Zero, the default, means no limit. This is most useful with
+    // tests that emit many `download-speed` events, e.g. NDT and DASH.
+    //
+    // When the logger is async, coalesced events are delivered by the
+    // background thread as soon as the rate allows it. When it is not async,
+    // instead, there is no thread that could deliver an event later. Hence,
+    // an event emitted faster than the rate allows is not delivered, but kept
+    // aside, replacing the event of the same type and stream kept aside
+    // previously, if any. The next event of the same type and stream emitted
+    // when the rate allows it is delivered as usual by the emitting thread,
+    // and makes the event kept aside obsolete. The events still kept aside
+    // when the test ends are delivered by the thread running the test right
+    // before it emits `phase-summary`.
+    Logger &set_max_event_rate(double events_per_second);
+
   private:
     class Impl;
     mk::Safe<std::unique_ptr<Impl>> impl_;
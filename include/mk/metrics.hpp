@@ -0,0 +1,66 @@
+// Part of measurement-kit <https://measurement-kit.github.io/>.
+// Measurement-kit is free software under the BSD license. See AUTHORS
+// and LICENSE for more information on the copying conditions.
+#ifndef MK_METRICS_HPP
+#define MK_METRICS_HPP
+
+// The `mk/metrics.hpp` header defines functions to read the metrics that
+// measurement-kit collects while running, e.g. to feed a dashboard.
+
+#include <string> // for std::string
+#include <vector> // for std::vector
+
+namespace mk {
+
+// ## Metrics
+//
+// measurement-kit keeps process wide counters, gauges and histograms that
+// are always updated, regardless of the tests configuration. To avoid any
+// contention, each thread updates its own shard of each metric using relaxed
+// atomic operations, and shards are only summed when you read the metrics.
+//
+// The following metrics are available. Counters end with `_total` and
+// histograms follow the OpenMetrics conventions (i.e. they are exported as
+// `_bucket`, `_sum` and `_count` samples).
+//
+// - `mk_tests_started_total` and `mk_tests_finished_total`, labeled with
+// `test_name`, count the tests started and finished;
+//
+// - `mk_entries_total`, labeled with `test_name`, counts the emitted entries;
+//
+// - `mk_bytes_read_total` and `mk_bytes_written_total` count the bytes read
+// from and written to the network;
+//
+// - `mk_dns_cache_hits_total` and `mk_dns_cache_misses_total` are the same
+// counters returned by `dns_cache_stats()` (see `mk/dns.hpp`);
+//
+// - `mk_collector_submission_seconds` is the histogram of the time required
+// to submit an entry (or a batch of entries) to the collector;
+//
+// - `mk_active_sockets` is the number of open sockets;
+//
+// - `mk_logger_queue_bytes` and `mk_file_report_queue_bytes` are the number
+// of bytes waiting in the queues of async loggers and of async file reports.
+//
+// The `MetricSample` struct contains the value of a metric sample. The `name`
+// field is the sample name (e.g. `mk_entries_total`), `labels` contains the
+// labels in OpenMetrics syntax (e.g. `test_name="web_connectivity"`) and is
+// empty when the sample has no labels, and `value` is the sample value.
+struct MetricSample {
+    std::string name;
+    std::string labels;
+    double value = 0.0;
+};
+
+// The `metrics_snapshot()` function returns the current value of all the
+// metric samples. Each sample is read atomically, but samples are not all
+// read at the same time.
+std::vector<MetricSample> metrics_snapshot();
+
+// The `metrics_openmetrics()` function returns the current value of all the
+// metric samples in the OpenMetrics text format, including `# TYPE` and
+// `# HELP` lines, so that you can serve it from your own HTTP endpoint.
+std::string metrics_openmetrics();
+
+} // namespace mk
+#endif
@@ -10,14 +10,124 @@
 // that occur during the test. If your are integrating measurement-kit
 // as an engine for running tests, this is the API that you want to use.
 
-#include <cstdint>       // for unint32_t
-#include <functional>    // for std::function<>
-#include <mk/logger.hpp> // for mk::Logger
-#include <mk/safe.hpp>   // for mk::Safe<>
-#include <string>        // for std::string
+#include <cstddef>          // for size_t
+#include <cstdint>          // for unint32_t
+#include <functional>       // for std::function<>
+#include <memory>           // for std::shared_ptr<>, std::unique_ptr<>
+#include <mk/bootstrap.hpp> // for mk::BootstrapContext
+#include <mk/logger.hpp>    // for mk::Logger
+#include <mk/safe.hpp>      // for mk::Safe<>
+#include <string>           // for std::string
 
 namespace mk {
 
+// ## Initialization
+//
+// The `warmup()` function initializes in advance the subsystems that would
+// otherwise be initialized lazily by the first test that needs them (see
+// the "Initialization" section of `BaseTest`). This includes loading the CA
+// bundle at `ca_bundle_path`, or the default one if empty, which will be
+// shared by the tests using the same `MK_OPT_CA_BUNDLE_PATH`. It is safe to
+// call this function more than once and from many threads.
+void warmup(std::string ca_bundle_path = "");
+
+// ## The TestHandle class
+//
+// The `TestHandle` class allows you to control a test started in the
+// background using `BaseTest::start_with_handle()`, or obtained from a
+// `TestTask`. Copying a handle yields another handle for the same test. All
+// its methods can be called from any thread, including from the callbacks
+// of the test itself, and after the test is done, in which case they have
+// no effect.
+//
+// When a test is cancelled, or its deadline expires, all its pending I/O is
+// interrupted, the measurement in progress (if any) is abandoned without
+// emitting its entry, and the remaining inputs are not measured. The test
+// then closes its reports and calls the `on_end()` and `on_destroy()`
+// callbacks as well as the callback passed to `start_with_handle()`, as
+// when the test ends normally.
+//
+// ### Methods
+class TestHandle {
+  public:
+    // The default constructor creates an empty handle. Calling any method on
+    // an empty handle throws `std::runtime_error`.
+    TestHandle();
+
+    // The `cancel()` method requests the test to stop as soon as possible.
+    void cancel();
+
+    // The `set_deadline()` method requests the test to stop if it is still
+    // running after the specified number of seconds from now. Calling this
+    // method again replaces the previous deadline.
+    void set_deadline(double seconds);
+
+    // The `done()` method returns whether the test is done.
+    bool done() const;
+
+  private:
+    class Impl;
+    mk::Safe<std::shared_ptr<Impl>> impl_;
+};
+
+// ## The TestTask class
+//
+// The `TestTask` class allows you to consume the entries of a test started
+// in the background using `BaseTest::start_task()`, or run by a `TestRunner`
+// after being added with `TestRunner::add_task()`, without registering any
+// callback. This is meant to allow a single thread to drive many tests,
+// for example from an event loop or from a coroutine scheduler. Rather than
+// blocking, such thread registers a ready handler, pulls the available
+// entries when the handler is called, and goes back to do other work.
+//
+// Entries are queued into the task until taken with `next_entry()`. To keep
+// the memory usage bounded, the test does not start measuring more inputs
+// while more than `MK_OPT_PARALLELISM` entries are waiting to be taken.
+//
+// Copying a `TestTask` yields another handle for the same task. A task
+// should be consumed by a single thread at a time.
+//
+// ### Methods
+class TestTask {
+  public:
+    // The default constructor creates an empty task. Calling any method on
+    // an empty task throws `std::runtime_error`.
+    TestTask();
+
+    // The `on_ready()` method sets the ready handler. This handler is called
+    // from the thread running the test whenever a new entry is available and
+    // when the test is done. If entries are already available, or the test
+    // is already done, when the handler is set, the handler is also called
+    // right away. The handler should return quickly, e.g. after waking up
+    // the thread consuming the task.
+    TestTask &on_ready(std::function<void()> &&cb);
+
+    // The `next_entry()` method does not block. It moves the next available
+    // entry into `entry`, as serialized JSON, and returns `true`. If no
+    // entry is available, it returns `false`.
+    bool next_entry(std::string &entry);
+
+    // The `wait()` method blocks until an entry is available or until the
+    // test is done. It is meant for code that does not use a ready handler.
+    void wait();
+
+    // The `done()` method returns `true` when the test is done and all its
+    // entries have been taken.
+    bool done() const;
+
+    // The `summary()` method returns the serialized JSON of the
+    // `phase-summary` event emitted at the end of the test. It returns an
+    // empty string if the test is not done yet.
+    const char *summary() const;
+
+    // The `handle()` method returns the handle to control the test.
+    TestHandle handle() const;
+
+  private:
+    class Impl;
+    mk::Safe<std::shared_ptr<Impl>> impl_;
+};
+
 // ## The BaseTest class
 //
 // The `BaseTest` class is common to all tests. With its methods it allows you
@@ -46,10 +156,18 @@ namespace mk {
 // Once you have configured the test, you can run it using `run()` or
 // `start()`. The former executes the test and blocks until it id done.
 // The latter starts the test in a background thread and calls the
-// callback specified as argument when done. Do not assume that `run()`
-// will run the test in the current thread. Different versions of MK
-// may run it in a background thread and block the current thread until
-// the test is complete.
+// callback specified as argument when done. If you need to stop the test
+// early, use `start_with_handle()` instead, which also returns a
+// `TestHandle` (see above). Do not assume that `run()` will run the test in
+// the current thread. Different versions of MK may run it in a background
+// thread and block the current thread until the test is complete.
+//
+// If you need to run many tests concurrently, you probably do not want
+// to use `start()` for each of them, because each started test owns its
+// background thread. Instead, pass the configured tests to a `TestRunner`
+// (see `mk/runner.hpp`), which runs many tests over a fixed pool of threads.
+// To run several different tests back to back, consider using a `Session`
+// (see `mk/session.hpp`), which performs the bootstrap only once.
 //
 // The same `BaseTest` (or derived class) cannot be used to start more
 // than one test. This is because, when the test is started, we move
@@ -59,6 +177,10 @@ namespace mk {
 // version of MK, this may either result to the callback being called
 // "soon" with an error code or to an exception being raised.
 //
+// If you want to run the same test repeatedly, configure it once and then use
+// `clone()` to obtain, for each run, a copy that you start instead of the
+// original. See the documentation of `clone()` for more information.
+//
 // The fact that we want the background thread to have exclusive ownership
 // of state also explains why we expect all callbacks to be moved, thus
 // transferring ownership, rather than just copied.
@@ -72,6 +194,93 @@ namespace mk {
 // any callback will be swallowed by the code (but a warning message
 // printing the description of the exception should be printed in most case).
 //
+// ### Resuming tests
+//
+// When `MK_OPT_RESUME` is set and an explicit output filepath has been set
+// with `set_output_filepath()`, the test keeps a journal of the completed
+// inputs in a file named like the output file with the `.journal` suffix.
+// The journal starts with a header containing the size and the modification
+// time of each input file, as well as the hash of the inputs added with
+// `add_input()`. Inputs read from files are recorded by file and offset,
+// while other inputs are recorded by their position, and each record also
+// contains the size of the output file after the entry of the input was
+// written. The journal is append-only, and each record is a few bytes long.
+//
+// An input is recorded into the journal only after its entry has been written
+// to the output file and the output file has been synced to storage (i.e.
+// using `fsync()`, also when `MK_OPT_ASYNC_FILE_REPORT` is set). Hence, even
+// after a power loss, the output file is not shorter than the size contained
+// in the last record that reached the storage. To amortize the cost of
+// syncing, the records of the entries written together are appended together.
+//
+// If the journal exists when such test starts, its header is compared with
+// the current input files and inputs. If they match, the output file is
+// truncated to the size contained in the last complete record of the journal,
+// thus removing any entry that was only partially written when the test was
+// interrupted, and it is then opened for appending, rather than truncated.
+// A partially written record at the end of the journal is likewise ignored.
+// Should the output file nonetheless be shorter than such size (e.g. because
+// it was modified), the test uses instead the last record whose size fits
+// within the output file, and ignores the subsequent records, so that the
+// output file is never extended, nor padded with zero bytes.
+//
+// The inputs recorded in the records that are used are then skipped. Since
+// the journal also records the offset before which all the inputs of a file
+// have been completed, the test directly seeks to such offset within the
+// file, rather than reading it from the beginning. Inputs returned by an
+// input source, instead, must be pulled again and discarded, because a source
+// cannot seek, and changes to them cannot be detected.
+//
+// If the header does not match (e.g. because an input file has been modified
+// since the journal was written), or the journal is invalid, a warning is
+// emitted, the journal is discarded and the test starts over, truncating the
+// output file. To start over explicitly, remove the output file and its
+// journal. This option is ignored if no output filepath has been set, as in
+// such case the output file name depends on the current time.
+//
+// ### Serialization
+//
+// Entries, events, and detailed failures are serialized as compact JSON (i.e.
+// there is no whitespace between tokens). Within strings, only `"`, `\` and
+// the control characters below U+0020 are escaped, the latter using the
+// short escapes (e.g. `\n`) when available and `\u00XX` otherwise. Every
+// other character, including `/` and non-ASCII characters, is copied as is.
+// Strings that are not valid UTF-8 (e.g. binary HTTP bodies) are replaced
+// by an object containing `"format": "base64"` and the base64 encoded string
+// as `data`, as required by the OONI specification. Because of this narrow
+// escaping rule, measurement-kit may use vector instructions (where available)
+// to quickly find the characters to escape in large bodies, with the output
+// being the same regardless of the instructions being used.
+//
+// Each test serializes entries into a buffer that is reused for subsequent
+// entries. This is the buffer passed to the `on_entry()` handlers, hence the
+// pointer they receive is invalidated after the handler returns.
+//
+// ### Input
+//
+// Tests that take input (e.g. `WebConnectivityTest`) measure, in order, the
+// inputs added with `add_input()`, the inputs read from the files specified
+// with `add_input_filepath()` (or `set_input_filepath()`), and the inputs
+// returned by the function set with `set_input_source()`. Files and input
+// sources are not read in advance. Rather, the next input is pulled when the
+// test is ready to measure it. Therefore, the memory used by a test does not
+// depend on the number of inputs in its files or sources.
+//
+// By default, inputs are measured one after the other. Using the option
+// `MK_OPT_PARALLELISM` you can allow a test to measure more inputs at the
+// same time, in which case the test pulls another input whenever one of
+// its measurements completes and its entry is emitted. Entries are still
+// emitted in the order of the inputs, unless `MK_OPT_UNORDERED_ENTRIES` is
+// set, so an entry that is waiting for the entries of previous inputs keeps
+// occupying its slot. Use `MK_OPT_INPUT_TIMEOUT` to prevent a slow input from
+// stalling the test.
+//
+// Large input files can be indexed (`MK_OPT_INPUT_INDEX`), so that later runs
+// do not need to scan them again, deduplicated (`MK_OPT_DEDUPLICATE_INPUTS`),
+// and split among many probes (`MK_OPT_INPUT_SHARD_COUNT`). The index also
+// allows a resumed test (see "Resuming tests") to seek directly to its first
+// pending input.
+//
 // ### Test sequence
 //
 // Here we describe the sequence of operations performed when running a
@@ -116,6 +325,10 @@ namespace mk {
 // ASN database, the previously discovered probe IP is mapped to the ASN of the
 // probe. If the lookup fails, the probe ASN is set to `AS0`.
 //
+// The databases used in steps 7 and 8 are mapped in memory once and shared
+// by all the tests using the same paths (see `mk/geoip.hpp`). You can also
+// use `GeoipDatabase` to perform lookups without running a test.
+//
 // 9. Unless `MK_OPT_SAVE_PROBE_IP` is explicitly set to true, the probe IP
 // is then discarded and replaced with `127.0.0.1`.
 //
@@ -130,7 +343,7 @@ namespace mk {
 //
 // 13. Unless `MK_OPT_NO_RESOLVER_LOOKUP` is explicitly set to true, we try to
 // understand the IP address of the resolver. Depending on how the DNS engine
-// is configured (options `MK_OPT_DNS_RESOLVER` and `MK_OPT_DNS_ENGINE`, by
+// is configured (`MK_OPT_DNS_NAMESERVER_HINT` and `MK_OPT_DNS_ENGINE`, by
 // default both empty), this may entail a different algorithm. If discovering
 // the DNS resolver fails and `MK_OPT_FAIL_IF_RESOLVER_LOOKUP_FAILS` is
 // explicitly set to true, the test will fail. Otherwise, it will continue.
@@ -141,7 +354,104 @@ namespace mk {
 // and current-time dependent name will be written in the current working
 // directory. If opening the file fails and
 // `MK_OPT_FAIL_IF_OPEN_FILE_REPORT_FAILS` is explicitly set to true,
-// the test will fail. Otherwise it will continue.
+// the test will fail. Otherwise it will continue. By default entries are
+// written to the file by the thread running the test. Set the option
+// `MK_OPT_ASYNC_FILE_REPORT` to write them in batches from a background
+// thread, which is useful when writing to slow storage. Entries are written
+// as JSON lines, unless `MK_OPT_FILE_REPORT_FORMAT` selects another format.
+//
+// After the output file is opened, unless `MK_OPT_NO_COLLECTOR` is explicitly
+// set to true, a report is opened with the collector. Each entry is then
+// submitted to the collector as soon as it is available and, when the test
+// is done, the report is closed. Connections to the collector are taken from
+// a pool shared by all the tests running in the process and keyed by the
+// collector base URL and by the CA bundle (see `MK_OPT_CA_BUNDLE_PATH`).
+// Connections are kept alive for reuse, closed after being idle for some tens
+// of seconds, and TLS sessions are resumed when opening new connections to
+// the same collector. The cache of TLS sessions has the same key, hence a
+// test never uses a connection, nor resumes a session, whose certificate was
+// verified with another CA bundle. Use the option
+// `MK_OPT_COLLECTOR_PIPELINE_DEPTH` to pipeline the submission of entries.
+//
+// With `MK_OPT_COLLECTOR_BATCH_SIZE`, entries are instead submitted in batches,
+// optionally compressed according to `MK_OPT_COLLECTOR_COMPRESSION`. A batch
+// is submitted when it is full, when its oldest entry has been waiting for
+// `MK_OPT_COLLECTOR_BATCH_DELAY` seconds, or when the test is done, in which
+// case it is submitted before closing the report. A batch that fails is
+// retried as a whole. If the collector does not support batches, or the
+// requested compression, entries are submitted one at a time, uncompressed.
+// Batching does not affect the output file, where each entry is written as
+// soon as it is available.
+//
+// When a `BootstrapContext` is set using `set_bootstrap_context()`, steps 3
+// through 13 use the results cached in the context, if any, as explained
+// in `mk/bootstrap.hpp`. Steps 9 through 12 are always performed.
+//
+// ### Phase events
+//
+// While running, a test emits events, through the handler registered with
+// `Logger::on_event`, to tell you how much time was spent in each phase
+// of the test sequence. Like all events, these are JSON objects whose
+// `type` key identifies the kind of event.
+//
+// When a phase completes, a `phase-complete` event is emitted. Its `phase`
+// key is one of `init` (see "Initialization" below), `bouncer` (step 3),
+// `ip_lookup` (step 6), `geoip_lookup` (steps 7 and 8), `resolver_lookup`
+// (step 13), `open_file_report` (step 14), `open_collector_report`,
+// `measurement` (emitted once per input, with the `input` key containing the
+// input, if any), `close_collector_report`, and `close_file_report`. The
+// `start` key is the time when the phase started, in seconds, according to
+// a monotonic clock with an unspecified origin. The `elapsed` key is the
+// duration of the phase, in seconds. The `failure` key is `null` on success
+// and the failure string otherwise. The `cached` key is true when the phase
+// did not need to run, e.g. because its results were taken from a
+// `BootstrapContext`. Phases disabled by options (e.g. by
+// `MK_OPT_NO_BOUNCER`) do not emit any event. The events of the `measurement`
+// phase also include the number of memory allocations that the allocators of
+// measurement-kit performed on behalf of the measurement (`allocations`),
+// and the number of bytes allocated from the arena of the measurement
+// (`arena_bytes`, see the option `MK_OPT_MEASUREMENT_ARENA_SIZE`). The former
+// counts each arena block, or each object allocated individually when the
+// arena is disabled. Neither value includes the allocations performed in the
+// meanwhile by other threads, by the libraries used by measurement-kit, or by
+// your callbacks, hence they are not a measure of the allocations performed
+// by the whole process.
+//
+// Right before calling the handler registered with `on_end()`, a test emits
+// a `phase-summary` event. Its `phases` key is an object mapping the name of
+// each phase that was run to the total number of seconds spent in it, its
+// `elapsed` key is the total runtime of the test in seconds, and its
+// `time_to_first_entry` key is the number of seconds between the start of
+// the test and the first entry being emitted (`null` if there was none).
+// This event is delivered before `on_end()` is called, even when the logger
+// is async (see `Logger::set_async()`), and is also returned by the method
+// `TestTask::summary()`.
+//
+// ### Initialization
+//
+// The subsystems used by tests (e.g. the global state of the libraries used
+// by measurement-kit, the CA bundle, the DNS engines, the pools of
+// connections and buffers) are initialized lazily, the first time a test
+// needs them, and are then shared by all the subsequent tests. Therefore,
+// creating a test is cheap and a test only pays for what it uses. The time
+// spent initializing subsystems is reported by the `init` phase event, which
+// is `cached` when the test did not need to initialize anything.
+//
+// If you prefer to pay such cost in advance, e.g. when starting a server,
+// call `warmup()`. To also avoid mapping the GeoIP databases for each test,
+// keep a `GeoipDatabase` handle for each of them (see `mk/geoip.hpp`).
+//
+// ### Running tests against local servers
+//
+// To obtain reproducible results, e.g. when comparing the performance of
+// different versions of measurement-kit, you can configure a test so that
+// it only talks with servers running on the loopback interface. To this end,
+// set `MK_OPT_NO_BOUNCER`, point `MK_OPT_COLLECTOR_BASE_URL` (or set
+// `MK_OPT_NO_COLLECTOR`) and the test specific helper options (e.g.
+// `MK_OPT_WEB_CONNECTIVITY_HELPER`) to local servers, and set explicitly the
+// `MK_OPT_PROBE_IP`, `MK_OPT_PROBE_ASN` and `MK_OPT_PROBE_CC` options and
+// `MK_OPT_NO_RESOLVER_LOOKUP`, so that no lookup is performed. Also setting
+// `MK_OPT_NO_FILE_REPORT` removes the cost of writing the output file.
 //
 // ### Methods
 class BaseTest {
@@ -168,24 +478,57 @@ class BaseTest {
 
     BaseTest &set_logger(Logger logger);
 
+    // The `set_bootstrap_context()` method sets the context used to share
+    // the results of the bootstrap steps with other tests. Each test is
+    // created with its own context, whose TTL is 300 seconds, so that the
+    // clones of a test (see `clone()`) share the bootstrap results, and yet
+    // a change of network (e.g. of the probe IP) is noticed within minutes
+    // when running a clone periodically. This method replaces such context.
+    BaseTest &set_bootstrap_context(BootstrapContext context);
+
     BaseTest &add_input(std::string s);
 
     BaseTest &add_input_filepath(std::string s);
 
     BaseTest &set_input_filepath(std::string s);
 
+    // The `set_input_source()` method sets the function from which to pull
+    // the inputs. The function will be called from the thread running the
+    // test whenever the test is ready to measure another input. It should
+    // store the next input into its argument and return `true`, or return
+    // `false` when there are no more inputs. See also `mk/input.hpp`.
+    BaseTest &set_input_source(std::function<bool(std::string &)> &&fn);
+
     BaseTest &set_output_filepath(std::string s);
 
     BaseTest &set_error_filepath(std::string s);
 
+    // The deprecated `set_options()` method is like `set_option()`, including
+    // the handling of unknown keys, except that it never throws. An invalid
+    // value for a known option is instead reported as a warning when the test
+    // starts, and the option keeps its default value.
     [[deprecated]] BaseTest &set_options(std::string key, std::string value);
 
+    // The `set_option()` method sets the option `key` to `value`. The value
+    // is validated and parsed according to the option registry defined in
+    // `mk/options.hpp`. If `value` is not a valid value for such option,
+    // `std::invalid_argument` is thrown. If `key` is not in the registry, the
+    // value is stored as a string, for the benefit of the code that may use
+    // it, and a warning naming the unknown option is logged when the test
+    // starts.
     BaseTest &set_option(std::string key, std::string value);
 
     [[deprecated]] BaseTest &on_entry(std::function<void(std::string)> &&cb);
 
     BaseTest &on_entry(std::function<void(const char *)> &&cb);
 
+    // The `on_entry()` method with data and length sets a handler called
+    // with the buffer where the entry has been serialized, thus avoiding a
+    // copy of the entry and the computation of its length. The buffer is
+    // only valid until the handler returns and is not guaranteed to be NUL
+    // terminated. If more than one entry handler is set, the last one wins.
+    BaseTest &on_entry(std::function<void(const char *, size_t)> &&cb);
+
     BaseTest &on_begin(std::function<void()> &&cb);
 
     BaseTest &on_end(std::function<void()> &&cb);
@@ -196,6 +539,50 @@ class BaseTest {
 
     void start(std::function<void()> &&cb);
 
+    // The `start_with_handle()` method is like `start()`, except that it also
+    // returns a `TestHandle` for controlling the test. It is a distinct method,
+    // rather than a different return type for `start()`, so that applications
+    // compiled against previous versions of this header keep working.
+    TestHandle start_with_handle(std::function<void()> &&cb);
+
+    // The `start_task()` method starts the test in the background and returns
+    // a `TestTask` for consuming its entries. Handlers registered with the
+    // `on_entry()` method, if any, are called as well. Unlike `start()`, this
+    // method does not create a background thread per test. Rather, all the
+    // tests started with this method run over a process wide pool of I/O
+    // threads, as many as the number of CPUs, created when this method is
+    // first called. To control the threads and the concurrency, add the test
+    // to a `TestRunner` using `TestRunner::add_task()` instead.
+    TestTask start_task();
+
+    // The `clone()` method returns a test of the same kind, configured like
+    // this test, that can be started independently. It must be called before
+    // this test is started. The configuration (options, inputs, file paths)
+    // is shared copy-on-write, so cloning is cheap, and configuring the clone
+    // does not change this test. The state of each run (e.g. entries, report
+    // ID) is never shared. As a clone uses the same output filepath, you
+    // probably want to change it.
+    //
+    // The callbacks are shared by this test and all its clones, therefore they
+    // must be safe to call concurrently if you run clones concurrently. Each
+    // of them is called for each run as documented, e.g. the `on_destroy()`
+    // callback is called once by each test (or clone) when its run is over.
+    //
+    // Since a `Logger` cannot be copied, when you set a logger using the
+    // `set_logger()` method the test takes ownership of it, and then shares
+    // such ownership with all its clones, which all log through the same
+    // logger. Therefore, the handlers of the logger must also be safe to call
+    // concurrently. The `Logger::on_destroy()` handler is called only once,
+    // when the last test (or clone) sharing the logger is destroyed.
+    //
+    // The bootstrap context is also shared by this test and all its clones,
+    // so that only the first run performs the bootstrap and the subsequent
+    // runs reuse its results until they expire. Since each test is created
+    // with its own context (see `set_bootstrap_context()`), this method does
+    // not modify this test and can be called concurrently. Call the method
+    // `set_bootstrap_context()` on a clone to prevent this sharing.
+    std::unique_ptr<BaseTest> clone() const;
+
   private:
     class Impl;
     mk::Safe<std::unique_ptr<Impl>> impl_;
@@ -211,6 +598,16 @@ class BaseTest {
 
 /* TODO: write a description message before each test */
 
+// The `DashTest` measures the quality of video streaming, emulating a
+// DASH client downloading video segments at increasing bitrates. It emits
+// `download-speed` events while downloading.
+//
+// With `MK_OPT_NUM_STREAMS` greater than one, the download is performed using
+// many parallel streams. In such case, each stream emits its own
+// `download-speed` events, with the `stream` key containing the stream index,
+// and the test also emits aggregated `download-speed` events, without the
+// `stream` key, whose speed is the sum of the speeds of all streams. See
+// also `MK_OPT_PIN_STREAMS_TO_CPUS` and `MK_OPT_ZERO_COPY_RECEIVE`.
 MK_DECLARE_TEST(DashTest);
 
 MK_DECLARE_TEST(CaptivePortalTest);
@@ -225,6 +622,10 @@ MK_DECLARE_TEST(HttpInvalidRequestLineTest);
 
 MK_DECLARE_TEST(MeekFrontedRequestsTest);
 
+// The `ExtendedNetworkDiagnosticTest` measures the download and upload
+// speed using the NDT protocol. It emits `download-speed` events during the
+// download phase. Like `DashTest`, it can download using many parallel
+// streams, in which case it emits per-stream and aggregated events.
 MK_DECLARE_TEST(ExtendedNetworkDiagnosticTest);
 
 using MultiNdtTest = ExtendedNetworkDiagnosticTest; // backward compat alias
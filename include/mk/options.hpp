@@ -7,8 +7,24 @@
 // The `mk/options.hpp` header defines all the available MK options. Rather
 // than hardcoding option names, you should use the corresponding defines.
 //
+// All options are described by a registry (see below) specifying their type,
+// default value and acceptable values. When you set an option, its value is
+// validated and parsed according to the registry, and then stored into an
+// array indexed by option identifier, so that reading an option while the
+// test is running does not entail any string lookup or parsing. Besides,
+// invalid values are reported when you configure a test, rather than while
+// the test is running. Options not in the registry (e.g. misspelled options,
+// or test specific options that have not been registered yet) are still
+// accepted, as in previous versions of measurement-kit, but a warning is
+// emitted when the test starts, so that misspellings are visible.
+//
 // Changing the defines names will bump the API. Changing the corresponding
-// strings instead will bump the ABI.
+// strings instead will bump the ABI. The same holds for the `OptionId` values
+// (see the registry below), which are used by the library as indexes: the
+// registry is therefore append only, and new options must be added at its
+// end, so that the identifiers of the existing options do not change.
+
+#include <cstdint> // for uint32_t
 
 // The `MK_DNS_NAMERSERVER_HINT` option is used to indicate what nameserver
 // should be used to resolve hostnames. Depending on the DNS engine in use, it
@@ -16,10 +32,462 @@
 // emitted, but the execution will contonue anyway.
 #define MK_DNS_NAMESERVER_HINT "dns/nameserver"
 
-// The `MK_DNS_ENGINE` option allows you to specify the engine to use. If the
-// requested engine is not available, all DNS queries will fail.
+// The `MK_DNS_ENGINE` option allows you to specify the engine to use. It may
+// be empty (the default), meaning the default engine, `system` (see
+// `MK_DNS_ENGINE_SYSTEM`), `libevent` (see `MK_DNS_ENGINE_LIBEVENT`) or
+// `caching`. If the requested engine has not been compiled in, all DNS
+// queries will fail. The special `caching` engine (see
+// `MK_DNS_ENGINE_CACHING`) uses a process wide cache, described in
+// `mk/dns.hpp`, on top of another engine.
 #define MK_DNS_ENGINE "dns/engine"
 
-/* TODO: define more options */
+// `MK_DNS_ENGINE_SYSTEM` is the name of the engine using the resolver of the
+// operating system (i.e. `getaddrinfo()`).
+#define MK_DNS_ENGINE_SYSTEM "system"
+
+// `MK_DNS_ENGINE_LIBEVENT` is the name of the engine using libevent's
+// asynchronous resolver.
+#define MK_DNS_ENGINE_LIBEVENT "libevent"
+
+// `MK_DNS_ENGINE_CACHING` is the name of the caching DNS engine.
+#define MK_DNS_ENGINE_CACHING "caching"
+
+// `MK_OPT_DNS_NAMESERVER_HINT` and `MK_OPT_DNS_ENGINE` are aliases for the
+// two options above that are named consistently with all the other options.
+#define MK_OPT_DNS_NAMESERVER_HINT MK_DNS_NAMESERVER_HINT
+#define MK_OPT_DNS_ENGINE MK_DNS_ENGINE
+
+// The `MK_OPT_DNS_CACHE_UPSTREAM_ENGINE` option is the engine used to resolve
+// the queries not found in the cache when `MK_DNS_ENGINE` is `caching`. It
+// may be empty (the default), meaning the default engine, `system` or
+// `libevent`.
+#define MK_OPT_DNS_CACHE_UPSTREAM_ENGINE "dns/cache_upstream_engine"
+
+// The `MK_OPT_DNS_CACHE_NEGATIVE_TTL` option is the number of seconds for
+// which failed queries are cached when `MK_DNS_ENGINE` is `caching`. The
+// default is `60`. Zero means that failures are not cached.
+#define MK_OPT_DNS_CACHE_NEGATIVE_TTL "dns/cache_negative_ttl"
+
+// The `MK_OPT_CA_BUNDLE_PATH` option is the path of the bundle of the CA
+// certificates used to validate TLS connections. When empty, the default
+// bundle is used. Each bundle is loaded once and shared by all the tests.
+#define MK_OPT_CA_BUNDLE_PATH "net/ca_bundle_path"
+
+// The `MK_OPT_NO_BOUNCER` option, when explicitly set to true, prevents the
+// test from querying the bouncer (step 3 of the test sequence).
+#define MK_OPT_NO_BOUNCER "no_bouncer"
+
+// The `MK_OPT_BOUNCER_BASE_URL` option is the base URL of the OONI bouncer.
+#define MK_OPT_BOUNCER_BASE_URL "bouncer_base_url"
+
+// The `MK_OPT_NO_COLLECTOR` option, when explicitly set to true, prevents the
+// test from submitting entries to the collector.
+#define MK_OPT_NO_COLLECTOR "no_collector"
+
+// The `MK_OPT_COLLECTOR_BASE_URL` option is the base URL of the collector.
+// It overrides the collector returned by the bouncer (step 4).
+#define MK_OPT_COLLECTOR_BASE_URL "collector_base_url"
+
+// The `MK_OPT_NO_COLLECTOR_CONNECTION_POOL` option, when explicitly set to
+// true, causes the test to use its own connections to the collector, rather
+// than the ones of the process wide pool (see `mk/nettests.hpp`).
+#define MK_OPT_NO_COLLECTOR_CONNECTION_POOL "no_collector_connection_pool"
+
+// The `MK_OPT_COLLECTOR_PIPELINE_DEPTH` option is the maximum number of
+// entries that the test may be submitting to the collector at the same time
+// over a single connection, using HTTP pipelining. The default is `1`, which
+// means that an entry is sent only after the previous one was acknowledged.
+#define MK_OPT_COLLECTOR_PIPELINE_DEPTH "collector_pipeline_depth"
+
+// The `MK_OPT_COLLECTOR_BATCH_SIZE` option is the maximum number of entries
+// submitted to the collector with a single request. The default is `1`,
+// meaning that each entry is submitted with its own request.
+#define MK_OPT_COLLECTOR_BATCH_SIZE "collector_batch_size"
+
+// The `MK_OPT_COLLECTOR_BATCH_DELAY` option is the maximum number of seconds
+// that an entry waits for the current batch to be full before the batch is
+// submitted anyway. The default is `5.0`.
+#define MK_OPT_COLLECTOR_BATCH_DELAY "collector_batch_delay"
+
+// The `MK_OPT_COLLECTOR_COMPRESSION` option is the compression applied to the
+// body of each request submitting entries. It may be empty (the default),
+// meaning no compression, `gzip` or `zstd`. Compression is most useful in
+// combination with `MK_OPT_COLLECTOR_BATCH_SIZE`.
+#define MK_OPT_COLLECTOR_COMPRESSION "collector_compression"
+
+// The `MK_OPT_COLLECTOR_MAX_RETRIES` option is the number of times that the
+// submission of a batch (or of a single entry) is retried, with exponential
+// backoff, before giving up. The default is `3`.
+#define MK_OPT_COLLECTOR_MAX_RETRIES "collector_max_retries"
+
+// The `MK_OPT_WEB_CONNECTIVITY_HELPER` option is the base URL of the Web
+// Connectivity test helper. It overrides the test helper returned by the
+// bouncer (step 5).
+#define MK_OPT_WEB_CONNECTIVITY_HELPER "web_connectivity_helper"
+
+// The `MK_OPT_NO_IP_LOOKUP` option, when explicitly set to true, prevents the
+// test from looking up the probe IP (step 6).
+#define MK_OPT_NO_IP_LOOKUP "no_ip_lookup"
+
+// The `MK_OPT_FAIL_IF_IP_LOOKUP_FAILS` option, when explicitly set to true,
+// causes the test to fail if the probe IP cannot be looked up (step 6).
+#define MK_OPT_FAIL_IF_IP_LOOKUP_FAILS "fail_if_ip_lookup_fails"
+
+// The `MK_OPT_PROBE_IP` option sets the probe IP. When this option is set,
+// the IP lookup (step 6) is not performed.
+#define MK_OPT_PROBE_IP "probe_ip"
+
+// The `MK_OPT_PROBE_ASN` option sets the probe ASN. When this option is set,
+// the GeoIP ASN lookup (step 8) is not performed.
+#define MK_OPT_PROBE_ASN "probe_asn"
+
+// The `MK_OPT_PROBE_CC` option sets the probe country code. When this option
+// is set, the GeoIP country lookup (step 7) is not performed.
+#define MK_OPT_PROBE_CC "probe_cc"
+
+// The `MK_OPT_NO_RESOLVER_LOOKUP` option, when explicitly set to true,
+// prevents the test from looking up the resolver IP (step 13).
+#define MK_OPT_NO_RESOLVER_LOOKUP "no_resolver_lookup"
+
+// The `MK_OPT_FAIL_IF_RESOLVER_LOOKUP_FAILS` option, when explicitly set to
+// true, causes the test to fail if the resolver IP cannot be looked up.
+#define MK_OPT_FAIL_IF_RESOLVER_LOOKUP_FAILS "fail_if_resolver_lookup_fails"
+
+// The `MK_OPT_NO_FILE_REPORT` option, when explicitly set to true, prevents
+// the test from writing entries to the output file (step 14).
+#define MK_OPT_NO_FILE_REPORT "no_file_report"
+
+// The `MK_OPT_FILE_REPORT_FORMAT` option is the format of the output file.
+// With `json` (the default, see `MK_FILE_REPORT_FORMAT_JSON`), each entry is
+// written as a JSON object followed by a newline. With `cbor` (see
+// `MK_FILE_REPORT_FORMAT_CBOR`), each entry is written as a CBOR map preceded
+// by its length in bytes, encoded as a 32 bit big endian integer.
+//
+// So that readers can extract the fixed OONI fields without decoding the
+// whole entry, the `test_name`, `probe_cc`, `probe_asn`,
+// `measurement_start_time`, `input` and `test_keys` keys are always the
+// first keys of each CBOR map, in this order, and `failure` is always the
+// first key of the `test_keys` map. Hence, the failure of the measurement is
+// at a fixed position as well, right after the first five fields, without
+// adding to the entry a top level key that is not in its JSON version. In
+// both cases entries are streamed to the file, and entries passed to the
+// `BaseTest::on_entry()` handler are always serialized as JSON.
+#define MK_OPT_FILE_REPORT_FORMAT "file_report_format"
+
+// `MK_FILE_REPORT_FORMAT_JSON` is the name of the JSON report format.
+#define MK_FILE_REPORT_FORMAT_JSON "json"
+
+// `MK_FILE_REPORT_FORMAT_CBOR` is the name of the CBOR report format.
+#define MK_FILE_REPORT_FORMAT_CBOR "cbor"
+
+// The `MK_OPT_FAIL_IF_OPEN_FILE_REPORT_FAILS` option, when explicitly set to
+// true, causes the test to fail if the output file cannot be opened.
+#define MK_OPT_FAIL_IF_OPEN_FILE_REPORT_FAILS "fail_if_open_file_report_fails"
+
+// The `MK_OPT_GEOIP_COUNTRY_PATH` option is the path of the GeoIP database
+// used to map the probe IP to the probe country code. The database is shared
+// with all the other users of the same path (see `mk/geoip.hpp`).
+#define MK_OPT_GEOIP_COUNTRY_PATH "geoip_country_path"
+
+// The `MK_OPT_GEOIP_ASN_PATH` option is the path of the GeoIP database used
+// to map the probe IP to the probe ASN. The database is shared with all the
+// other users of the same path (see `mk/geoip.hpp`).
+#define MK_OPT_GEOIP_ASN_PATH "geoip_asn_path"
+
+// The `MK_OPT_SAVE_PROBE_IP` option, when explicitly set to true, causes the
+// probe IP to be included into the results (step 9).
+#define MK_OPT_SAVE_PROBE_IP "save_probe_ip"
+
+// The `MK_OPT_SAVE_PROBE_ASN` option, when explicitly set to false, prevents
+// the probe ASN from being included into the results (step 10).
+#define MK_OPT_SAVE_PROBE_ASN "save_probe_asn"
+
+// The `MK_OPT_SAVE_PROBE_CC` option, when explicitly set to false, prevents
+// the probe CC from being included into the results (step 11).
+#define MK_OPT_SAVE_PROBE_CC "save_probe_cc"
+
+// The `MK_OPT_PARALLELISM` option is the maximum number of inputs that a
+// test may be measuring at the same time. The default is `1`, meaning that
+// inputs are measured one after the other. Tests not taking input, as well
+// as performance tests (e.g. `DashTest`), ignore this option.
+#define MK_OPT_PARALLELISM "parallelism"
+
+// The `MK_OPT_UNORDERED_ENTRIES` option controls the order in which entries
+// are emitted when `MK_OPT_PARALLELISM` is greater than one. By default, the
+// entries are emitted in the same order of the inputs, meaning that a
+// completed entry is held until all the entries of the previous inputs have
+// been emitted. A held entry still counts against `MK_OPT_PARALLELISM` until
+// it is emitted, hence a slow input stops the test from pulling more inputs,
+// rather than causing an unbounded number of entries to be held. If this
+// option is explicitly set to true, instead, each entry is emitted as soon as
+// its measurement is complete.
+#define MK_OPT_UNORDERED_ENTRIES "unordered_entries"
+
+// The `MK_OPT_INPUT_TIMEOUT` option is the maximum number of seconds that a
+// test may spend measuring a single input. When this time expires, the
+// measurement of the input is interrupted and its entry is emitted with
+// failure `MK_GENERIC_TIMEOUT_ERROR`. The default, zero, means that there is
+// no timeout.
+#define MK_OPT_INPUT_TIMEOUT "input_timeout"
+
+// The `MK_OPT_NUM_STREAMS` option is the number of parallel TCP streams
+// used by `ExtendedNetworkDiagnosticTest` and `DashTest` to measure the
+// download speed. The default is `1`. Other tests ignore this option.
+#define MK_OPT_NUM_STREAMS "num_streams"
+
+// The `MK_OPT_PIN_STREAMS_TO_CPUS` option, when explicitly set to true, causes
+// each stream used by multi-stream tests to be served by its own I/O thread
+// pinned to its own CPU, where the operating system allows it.
+#define MK_OPT_PIN_STREAMS_TO_CPUS "pin_streams_to_cpus"
+
+// The `MK_OPT_STREAM_BUFFER_SIZE` option is the size in bytes of each of the
+// receive buffers owned by each stream of multi-stream tests. The default
+// is `131072`.
+#define MK_OPT_STREAM_BUFFER_SIZE "stream_buffer_size"
+
+// The `MK_OPT_ZERO_COPY_RECEIVE` option, when explicitly set to true, allows
+// multi-stream tests to discard the received data without copying it to user
+// space (e.g. using `MSG_TRUNC` or `splice()` on Linux), where the operating
+// system supports it, since only the amount of data received matters.
+#define MK_OPT_ZERO_COPY_RECEIVE "zero_copy_receive"
+
+// The `MK_OPT_INPUT_INDEX` option, when explicitly set to true, causes the
+// test to build an index of each input file the first time the file is used,
+// and to reuse it for subsequent runs. The index contains the offset of each
+// input and its hash, and is stored next to the input file with the `.mkidx`
+// suffix. It is rebuilt when the size or the modification time of the input
+// file changes. If the index cannot be saved, it is only kept in memory.
+//
+// The index is written into a temporary file in the same directory, which is
+// then renamed into place, so that processes using the same input file never
+// see a partially written index. An index that is nonetheless truncated or
+// invalid (e.g. because it was written by an incompatible version) is
+// ignored and rebuilt, as if it did not exist.
+#define MK_OPT_INPUT_INDEX "input_index"
+
+// The `MK_OPT_DEDUPLICATE_INPUTS` option, when explicitly set to true, causes
+// the test to measure only the first occurrence of each input, considering
+// all the inputs of the test, i.e. those added with `add_input()`, those of
+// all its input files and those returned by its input source. Inputs are
+// compared after removing leading and trailing whitespaces, using their 64
+// bit FNV-1a hash (see below). To this end, the test keeps in memory the set
+// of the hashes of the inputs it has seen, which takes some bytes per
+// distinct input. With `MK_OPT_INPUT_INDEX`, such hashes are taken from the
+// index, rather than computed, and the index also marks the inputs that are
+// duplicates of previous inputs of the same file, which are skipped without
+// even being read. Duplicates across different files, and between files and
+// other inputs, are still found using the set of hashes.
+//
+// When a test is resumed (see `MK_OPT_RESUME`), the set is first filled with
+// the hashes of the inputs that are skipped because they were completed by
+// the interrupted run, so that their later duplicates are not measured. The
+// hashes of the skipped inputs of a file are read from its index, if any, or
+// computed by reading the skipped part of the file, without measuring them.
+#define MK_OPT_DEDUPLICATE_INPUTS "deduplicate_inputs"
+
+// The `MK_OPT_INPUT_SHARD_COUNT` and `MK_OPT_INPUT_SHARD_INDEX` options allow
+// you to split the inputs of a test among many processes, possibly running
+// on different hosts, such that each input is measured by exactly one of
+// them. The space of the 64 bit FNV-1a hashes of the inputs (compared as
+// above) is split in `MK_OPT_INPUT_SHARD_COUNT` ranges of equal size, and
+// the test only measures the inputs whose hash falls within the range with
+// index `MK_OPT_INPUT_SHARD_INDEX`. As the hash does not depend on the host,
+// on the process or on the measurement-kit version, all the processes with
+// the same inputs and shard count agree on the split. The test fails when it
+// starts if the shard index is not smaller than the shard count.
+#define MK_OPT_INPUT_SHARD_COUNT "input_shard_count"
+#define MK_OPT_INPUT_SHARD_INDEX "input_shard_index"
+
+// The `MK_OPT_RESUME` option, when explicitly set to true, allows a test that
+// was interrupted to resume from where it stopped, rather than measuring
+// again all its inputs. See the "Resuming tests" section of `mk/nettests.hpp`.
+// This option cannot be used with tests run by a `Session` (see the header
+// `mk/session.hpp`).
+#define MK_OPT_RESUME "resume"
+
+// The `MK_OPT_MEASUREMENT_ARENA_SIZE` option is the size in bytes of the
+// blocks of the arena from which each measurement allocates the objects
+// composing its entry (e.g. HTTP bodies and headers, DNS answers, failures).
+// The entry is then serialized into the buffer reused by all the entries of
+// the test (see the "Serialization" section of `mk/nettests.hpp`), which is
+// not allocated from the arena, and the whole arena is released at once after
+// the entry has been emitted. The default, zero, disables the arena, so that
+// each object is allocated individually.
+#define MK_OPT_MEASUREMENT_ARENA_SIZE "measurement_arena_size"
+
+// The `MK_OPT_MAX_RUNTIME` option is the maximum number of seconds that the
+// test may run. When this time expires, the test is stopped like when its
+// `TestHandle` deadline expires (see `mk/nettests.hpp`). The default, zero,
+// means no limit.
+#define MK_OPT_MAX_RUNTIME "max_runtime"
+
+// The `MK_OPT_ASYNC_FILE_REPORT` option controls how entries are written to
+// the output file. By default, each entry is written by the thread running
+// the test. If this option is explicitly set to true, entries are instead
+// queued and written in batches, using `writev()`, by a writer thread that
+// is shared by all the tests. A batch is written when either the flush
+// interval expires or the flush size is exceeded (see below). In any case all
+// queued entries are written, and the file is synced, before the callback
+// registered with `BaseTest::on_end()` is called.
+//
+// If the queue is full, the test waits until there is space in the queue
+// and, to make this visible, emits a `file-report-backpressure` event whose
+// JSON contains the number of queued bytes (`queued_bytes`) and the number of
+// seconds spent waiting (`elapsed`). Waiting is asynchronous: only this test
+// is suspended, while the thread running it does not block and keeps running
+// the other tests bound to it (e.g. when using a `TestRunner`).
+#define MK_OPT_ASYNC_FILE_REPORT "async_file_report"
+
+// The `MK_OPT_FILE_REPORT_FLUSH_INTERVAL` option is the maximum number of
+// seconds that queued entries wait before being written when the option
+// `MK_OPT_ASYNC_FILE_REPORT` is set. The default is `1.0`.
+#define MK_OPT_FILE_REPORT_FLUSH_INTERVAL "file_report_flush_interval"
+
+// The `MK_OPT_FILE_REPORT_FLUSH_SIZE` option is the number of queued bytes
+// above which queued entries are written without waiting for the flush
+// interval when `MK_OPT_ASYNC_FILE_REPORT` is set. The default is `65536`.
+#define MK_OPT_FILE_REPORT_FLUSH_SIZE "file_report_flush_size"
+
+// The `MK_OPT_FILE_REPORT_QUEUE_SIZE` option is the maximum number of bytes
+// that may be queued for writing by a test when `MK_OPT_ASYNC_FILE_REPORT`
+// is set. The default is `1048576`. An entry larger than this size is
+// queued only when the queue is empty.
+#define MK_OPT_FILE_REPORT_QUEUE_SIZE "file_report_queue_size"
+
+// ## Option registry
+//
+// The `MK_OPTIONS_TABLE` macro lists all the options defined above. For each
+// option, the macro passed as argument is called with the option identifier
+// (i.e. the name of the define without the `MK_OPT_` prefix), the type,
+// the default value, the minimum and maximum values accepted for numeric
+// options, and the values accepted for enumeration options, separated by
+// `|` (an empty item means that the empty string is accepted). When you add
+// an option, you must also add it here, after all the other options, and you
+// must never remove or reorder options, since the position of an option in
+// the registry is its identifier.
+#define MK_OPTIONS_TABLE(MK_XX)                                                \
+    MK_XX(DNS_NAMESERVER_HINT, string, "", 0, 0, "")                           \
+    MK_XX(DNS_ENGINE, enumeration, "", 0, 0, "|system|libevent|caching")       \
+    MK_XX(NO_BOUNCER, boolean, "false", 0, 0, "")                              \
+    MK_XX(BOUNCER_BASE_URL, string, "", 0, 0, "")                              \
+    MK_XX(NO_COLLECTOR, boolean, "false", 0, 0, "")                            \
+    MK_XX(COLLECTOR_BASE_URL, string, "", 0, 0, "")                            \
+    MK_XX(WEB_CONNECTIVITY_HELPER, string, "", 0, 0, "")                       \
+    MK_XX(NO_IP_LOOKUP, boolean, "false", 0, 0, "")                            \
+    MK_XX(FAIL_IF_IP_LOOKUP_FAILS, boolean, "false", 0, 0, "")                 \
+    MK_XX(PROBE_IP, string, "", 0, 0, "")                                      \
+    MK_XX(PROBE_ASN, string, "", 0, 0, "")                                     \
+    MK_XX(PROBE_CC, string, "", 0, 0, "")                                      \
+    MK_XX(NO_RESOLVER_LOOKUP, boolean, "false", 0, 0, "")                      \
+    MK_XX(FAIL_IF_RESOLVER_LOOKUP_FAILS, boolean, "false", 0, 0, "")           \
+    MK_XX(NO_FILE_REPORT, boolean, "false", 0, 0, "")                          \
+    MK_XX(FAIL_IF_OPEN_FILE_REPORT_FAILS, boolean, "false", 0, 0, "")          \
+    MK_XX(GEOIP_COUNTRY_PATH, string, "", 0, 0, "")                            \
+    MK_XX(GEOIP_ASN_PATH, string, "", 0, 0, "")                                \
+    MK_XX(SAVE_PROBE_IP, boolean, "false", 0, 0, "")                           \
+    MK_XX(SAVE_PROBE_ASN, boolean, "true", 0, 0, "")                           \
+    MK_XX(SAVE_PROBE_CC, boolean, "true", 0, 0, "")                            \
+    MK_XX(PARALLELISM, integer, "1", 1, 1024, "")                              \
+    MK_XX(UNORDERED_ENTRIES, boolean, "false", 0, 0, "")                       \
+    MK_XX(INPUT_TIMEOUT, number, "0", 0, 86400, "")                            \
+    MK_XX(ASYNC_FILE_REPORT, boolean, "false", 0, 0, "")                       \
+    MK_XX(FILE_REPORT_FLUSH_INTERVAL, number, "1.0", 0, 3600, "")              \
+    MK_XX(FILE_REPORT_FLUSH_SIZE, integer, "65536", 0, 1073741824, "")         \
+    MK_XX(FILE_REPORT_QUEUE_SIZE, integer, "1048576", 1, 1073741824, "")       \
+    MK_XX(DNS_CACHE_UPSTREAM_ENGINE, enumeration, "", 0, 0,                    \
+          "|system|libevent")                                                  \
+    MK_XX(DNS_CACHE_NEGATIVE_TTL, number, "60", 0, 86400, "")                  \
+    MK_XX(NO_COLLECTOR_CONNECTION_POOL, boolean, "false", 0, 0, "")            \
+    MK_XX(COLLECTOR_PIPELINE_DEPTH, integer, "1", 1, 64, "")                   \
+    MK_XX(COLLECTOR_BATCH_SIZE, integer, "1", 1, 10000, "")                    \
+    MK_XX(COLLECTOR_BATCH_DELAY, number, "5.0", 0, 3600, "")                   \
+    MK_XX(COLLECTOR_COMPRESSION, enumeration, "", 0, 0, "|gzip|zstd")          \
+    MK_XX(COLLECTOR_MAX_RETRIES, integer, "3", 0, 100, "")                     \
+    MK_XX(FILE_REPORT_FORMAT, enumeration, "json", 0, 0, "json|cbor")          \
+    MK_XX(MAX_RUNTIME, number, "0", 0, 86400, "")                              \
+    MK_XX(NUM_STREAMS, integer, "1", 1, 64, "")                                \
+    MK_XX(PIN_STREAMS_TO_CPUS, boolean, "false", 0, 0, "")                     \
+    MK_XX(STREAM_BUFFER_SIZE, integer, "131072", 4096, 67108864, "")           \
+    MK_XX(ZERO_COPY_RECEIVE, boolean, "false", 0, 0, "")                       \
+    MK_XX(MEASUREMENT_ARENA_SIZE, integer, "0", 0, 67108864, "")               \
+    MK_XX(RESUME, boolean, "false", 0, 0, "")                                  \
+    MK_XX(INPUT_INDEX, boolean, "false", 0, 0, "")                             \
+    MK_XX(DEDUPLICATE_INPUTS, boolean, "false", 0, 0, "")                      \
+    MK_XX(INPUT_SHARD_COUNT, integer, "1", 1, 65536, "")                       \
+    MK_XX(INPUT_SHARD_INDEX, integer, "0", 0, 65535, "")                       \
+    MK_XX(CA_BUNDLE_PATH, string, "", 0, 0, "")
+
+namespace mk {
+
+// The `OptionType` enum lists the types of the options. Boolean options accept
+// `true`, `false`, `1`, and `0`. Integer options accept decimal integers,
+// and number options accept decimal numbers, in both cases within the range
+// specified in the option registry. String options accept any string, while
+// enumeration options only accept one of the values listed in the registry.
+enum class OptionType : uint32_t {
+    boolean,
+    integer,
+    number,
+    string,
+    enumeration
+};
+
+// The `OptionDescriptor` struct describes an option. The `allowed_values`
+// field is the `|` separated list of the values accepted by an enumeration
+// option, and is empty for the other types.
+struct OptionDescriptor {
+    const char *name;
+    OptionType type;
+    const char *default_value;
+    double min_value;
+    double max_value;
+    const char *allowed_values;
+};
+
+// The `OptionId` enum contains an identifier for each option. The last value,
+// `count`, is the number of options.
+enum class OptionId : uint32_t {
+#define MK_XX(id, type, default_value, min_value, max_value, allowed_values)   \
+    id,
+    MK_OPTIONS_TABLE(MK_XX)
+#undef MK_XX
+    count
+};
+
+// The `OptionRegistry` class template holds the `descriptors` array, which
+// contains the descriptor of each option, indexed by option identifier. The
+// array is a static data member of a class template, rather than a variable
+// at namespace scope, so that all translation units refer to the same array,
+// as required by the inline `option_descriptor()` function below. You do not
+// need to specify the template argument, which only exists for this reason.
+template <typename Unused = void> class OptionRegistry {
+  public:
+    static constexpr OptionDescriptor descriptors[] = {
+#define MK_XX(id, type, default_value, min_value, max_value, allowed_values)   \
+    {MK_OPT_##id, OptionType::type, default_value, min_value, max_value,       \
+     allowed_values},
+        MK_OPTIONS_TABLE(MK_XX)
+#undef MK_XX
+    };
+};
+
+// Before C++17, a static constexpr data member that is odr-used needs a
+// definition outside of the class. Since C++17 it is implicitly inline, and
+// such definition is deprecated.
+#if __cplusplus < 201703L
+template <typename Unused>
+constexpr OptionDescriptor OptionRegistry<Unused>::descriptors[];
+#endif
+
+static_assert(sizeof(OptionRegistry<>::descriptors) /
+                      sizeof(OptionRegistry<>::descriptors[0]) ==
+                  static_cast<uint32_t>(OptionId::count),
+              "OptionRegistry and OptionId are out of sync");
+
+// The `option_descriptor()` function returns the descriptor of `id`.
+constexpr const OptionDescriptor &option_descriptor(OptionId id) {
+    return OptionRegistry<>::descriptors[static_cast<uint32_t>(id)];
+}
 
+} // namespace mk
 #endif
@@ -0,0 +1,97 @@
+// Part of measurement-kit <https://measurement-kit.github.io/>.
+// Measurement-kit is free software under the BSD license. See AUTHORS
+// and LICENSE for more information on the copying conditions.
+#ifndef MK_RUNNER_HPP
+#define MK_RUNNER_HPP
+
+// The `mk/runner.hpp` header defines the `mk::TestRunner` class. This is
+// what you want to use when you need to run many nettests concurrently
+// without dedicating a background thread to each one of them.
+
+#include <cstddef>         // for size_t
+#include <cstdint>         // for uint32_t
+#include <functional>      // for std::function
+#include <memory>          // for std::unique_ptr
+#include <mk/nettests.hpp> // for mk::BaseTest, mk::TestTask
+#include <mk/safe.hpp>     // for mk::Safe
+#include <string>          // for std::string
+
+namespace mk {
+
+// ## The TestRunner class
+//
+// The `TestRunner` class takes ownership of many configured tests and runs
+// them over a fixed-size pool of I/O threads. Each I/O thread runs its own
+// event loop. A test is bound to a thread when it starts and stays there
+// until it is complete, but idle threads steal pending tests from the queues
+// of busy threads, so that a few slow tests do not keep other threads idle.
+//
+// This is different from calling `BaseTest::start()` for each test, which
+// would instead create a background thread and an event loop per test.
+//
+// Like `BaseTest`, this class supports the FluentInterface style. The
+// configuration methods should be called before `run()` or `start()`. Like
+// `BaseTest`, a `TestRunner` cannot be started more than once, because the
+// internal state is moved to the background threads when it starts.
+//
+// Tests are started in the order in which they have been added, as long as
+// this does not violate the configured concurrency limits. The callbacks of
+// each test (e.g. `on_entry()`, `on_end()`) are called from the I/O thread
+// running the test, hence callbacks of different tests may be called
+// concurrently by different threads.
+//
+// ### Methods
+class TestRunner {
+  public:
+    // The default constructor creates a runner with as many I/O threads as
+    // the number of CPUs, and with unlimited concurrency.
+    TestRunner();
+
+    ~TestRunner();
+
+    // The `set_num_threads()` method sets the number of I/O threads. Zero
+    // means as many threads as the number of CPUs.
+    TestRunner &set_num_threads(uint32_t n);
+
+    // The `set_max_concurrency()` method sets the maximum number of tests
+    // that may be running at any given time, regardless of their type. Zero
+    // means that there is no limit.
+    TestRunner &set_max_concurrency(uint32_t n);
+
+    // The `set_max_concurrency_of()` method sets the maximum number of tests
+    // of the specified type that may be running at any given time. The test
+    // type is identified by the OONI test name (i.e. the `test_name` field
+    // of the results, e.g. `web_connectivity`). Zero means no limit.
+    TestRunner &set_max_concurrency_of(std::string test_name, uint32_t n);
+
+    // The `set_io_buffer_pool_size()` method sets the maximum number of bytes
+    // of I/O buffers that the tests run by this runner keep for reuse, rather
+    // than freeing them. The buffers in the pool are shared by all the tests
+    // of the runner. Tests run without a runner share a process wide pool
+    // of the default size, which is `4194304`. Zero disables the pool.
+    TestRunner &set_io_buffer_pool_size(size_t nbytes);
+
+    // The `add_test()` method transfers to the runner the ownership of a
+    // configured test that has not been started yet.
+    TestRunner &add_test(std::unique_ptr<BaseTest> test);
+
+    // The `add_task()` method is like `add_test()`, except that it returns a
+    // `TestTask` for consuming the entries of the test once the runner has
+    // started it (see `mk/nettests.hpp`). Until then, the task has no entries
+    // and is not done.
+    TestTask add_task(std::unique_ptr<BaseTest> test);
+
+    // The `run()` method runs all the tests and blocks until they are done.
+    void run();
+
+    // The `start()` method runs all the tests in the background and calls
+    // the callback specified as argument when all tests are done.
+    void start(std::function<void()> &&cb);
+
+  private:
+    class Impl;
+    mk::Safe<std::unique_ptr<Impl>> impl_;
+};
+
+} // namespace mk
+#endif
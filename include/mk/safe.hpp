@@ -14,7 +14,30 @@
 // using measurement-kit API, tho, it's unlikely you really need to
 // _use_ this abstraction.
 
-#include <stdexcept>
+#include <stdexcept> // for std::runtime_error
+#include <utility>   // for std::move
+
+#ifdef MK_SAFE_UNCHECKED
+#include <cassert> // for assert
+#endif
+
+// `MK_SAFE_UNCHECKED`, when defined, disables the checks performed by the
+// `Safe` class. In such case, accessing an empty pointer is only detected by
+// an assertion, which is compiled in only when `NDEBUG` is not defined. This
+// allows release builds where accessing a wrapped pointer costs just a load.
+// Since this changes the behavior of inline code, you should define it
+// consistently when you compile measurement-kit and the code using it.
+
+#if defined(__GNUC__) || defined(__clang__)
+#define MK_SAFE_UNLIKELY(expr) __builtin_expect(!!(expr), 0)
+#define MK_SAFE_COLD __attribute__((noinline, cold))
+#elif defined(_MSC_VER)
+#define MK_SAFE_UNLIKELY(expr) (expr)
+#define MK_SAFE_COLD __declspec(noinline)
+#else
+#define MK_SAFE_UNLIKELY(expr) (expr)
+#define MK_SAFE_COLD
+#endif
 
 namespace mk {
 
@@ -37,6 +60,11 @@ namespace mk {
 // only. If you need to perform other kind of operations with the underlying
 // smart pointer, use the `underlying()` method.
 //
+// The checks are designed to be cheap. The pointer being empty is marked as
+// unlikely and the code that throws is not inlined, so that each access only
+// costs a load, a compare and a predicted branch. See `MK_SAFE_UNCHECKED`
+// for removing also such cost.
+//
 // From a design point of view, we chose to wrap the underlying pointer
 // rather than extending it, because that seems clean and separates more
 // clearly the concerns on the underlying pointer and of this class.
@@ -55,24 +83,40 @@ template <typename PtrType> class Safe {
     // The `underlying()` method allows you to access the underlying pointer.
     PtrType &underlying() { return ptr_; }
 
+    // The `underlying()` const method allows you to inspect the underlying
+    // pointer, e.g. to check whether it is empty without throwing.
+    const PtrType &underlying() const { return ptr_; }
+
     // The `get()` method returns the raw pointer wrapped by the underlying
     // smart pointer, or throws if such raw pointer is `nullptr`.
     auto get() const {
-        if (!ptr_) {
-            throw std::runtime_error("null pointer");
+#ifdef MK_SAFE_UNCHECKED
+        assert(ptr_);
+#else
+        if (MK_SAFE_UNLIKELY(!ptr_)) {
+            throw_null_pointer();
         }
+#endif
         return ptr_.get();
     }
 
     // The `operator->()` method is equivalent to `get()`.
     auto operator-> () const { return get(); }
 
-    // The `operator*()` method is equivalent to `*get()`.
-    auto operator*() const { return *get(); }
+    // The `operator*()` method is equivalent to `*get()`. It returns a
+    // reference to the pointee, therefore it does not copy it.
+    auto &operator*() const { return *get(); }
 
   private:
+    [[noreturn]] MK_SAFE_COLD static void throw_null_pointer() {
+        throw std::runtime_error("null pointer");
+    }
+
     PtrType ptr_;
 };
 
 } // namespace mk
+
+#undef MK_SAFE_COLD
+#undef MK_SAFE_UNLIKELY
 #endif
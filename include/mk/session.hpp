@@ -0,0 +1,121 @@
+// Part of measurement-kit <https://measurement-kit.github.io/>.
+// Measurement-kit is free software under the BSD license. See AUTHORS
+// and LICENSE for more information on the copying conditions.
+#ifndef MK_SESSION_HPP
+#define MK_SESSION_HPP
+
+// The `mk/session.hpp` header defines the `mk::Session` class, which allows
+// you to run several tests together, sharing the bootstrap, the collector
+// connection and the output file.
+
+#include <cstdint>          // for uint32_t
+#include <functional>       // for std::function
+#include <memory>           // for std::unique_ptr
+#include <mk/bootstrap.hpp> // for mk::BootstrapContext
+#include <mk/nettests.hpp>  // for mk::BaseTest
+#include <mk/safe.hpp>      // for mk::Safe
+#include <string>           // for std::string
+
+namespace mk {
+
+// ## The Session class
+//
+// The `Session` class takes ownership of several configured tests (e.g. a
+// `TelegramTest`, a `FacebookMessengerTest` and a `WebConnectivityTest`) and
+// runs them as a group. Compared to running each test on its own, a session:
+//
+// - performs the bootstrap steps (steps 3 through 13 of the test sequence
+// documented in `mk/nettests.hpp`) once, and then shares the results with
+// all the tests using a `BootstrapContext`. As the session adds the name of
+// each of its tests to the context using `BootstrapContext::add_test_name()`,
+// the bouncer is queried once for all the tests, unless some of them set
+// different values for the options on which the bootstrap results are keyed
+// (see `mk/bootstrap.hpp`);
+//
+// - submits the entries of all the tests over the same, pipelined connection
+// to the collector (unless they use different collectors or CA bundles, see
+// the collector connection pool in `mk/nettests.hpp`), while still opening a
+// collector report per test, as required by the collector protocol;
+//
+// - writes the entries of all the tests into the same output file, in which
+// each entry is identified by its `test_name` key;
+//
+// - runs the tests concurrently, except the performance tests (i.e. `DashTest`
+// and the NDT tests), which run alone, so that they do not interfere with the
+// other tests, nor the other tests with them.
+//
+// The options set on the session apply to all its tests, except for the tests
+// where the same option has been explicitly set. The output filepaths of the
+// tests are ignored, since the session writes a single output file. Tests
+// are started in the order in which they have been added.
+//
+// Tests cannot be resumed when run by a session (see `MK_OPT_RESUME`), because
+// their entries are interleaved in the shared output file. Therefore, setting
+// `MK_OPT_RESUME` on the session, or adding a test where such option is set,
+// throws `std::invalid_argument`.
+//
+// For the same reason, the options controlling how the output file is written
+// (`MK_OPT_FILE_REPORT_FORMAT`, `MK_OPT_ASYNC_FILE_REPORT`,
+// `MK_OPT_FILE_REPORT_FLUSH_INTERVAL`, `MK_OPT_FILE_REPORT_FLUSH_SIZE`, and
+// `MK_OPT_FILE_REPORT_QUEUE_SIZE`) can only be set on the session, which
+// uses a single writer, configured accordingly, for all its tests. Adding a
+// test where any of these options is set throws `std::invalid_argument`.
+//
+// The session sets its `BootstrapContext` on each test it runs, replacing
+// the context set on the test, if any (e.g. the context shared by clones,
+// see `BaseTest::clone()`), so that all the tests of the session share the
+// same bootstrap. To share bootstrap results with other tests, or with other
+// sessions, pass their context to `set_bootstrap_context()`.
+//
+// Like `BaseTest`, this class supports the FluentInterface style and it
+// cannot be started more than once.
+//
+// ### Methods
+class Session {
+  public:
+    // The default constructor creates an empty session using its own
+    // `BootstrapContext`.
+    Session();
+
+    ~Session();
+
+    // The `set_bootstrap_context()` method sets the context to be used for
+    // the bootstrap. This is useful to share bootstrap results with other
+    // sessions, e.g. when running the same session periodically.
+    Session &set_bootstrap_context(BootstrapContext context);
+
+    // The `set_option()` method sets an option for all the tests of the
+    // session. Invalid values and unknown keys are handled as explained for
+    // `BaseTest::set_option()`.
+    Session &set_option(std::string key, std::string value);
+
+    // The `set_output_filepath()` method sets the path of the output file
+    // shared by all the tests. If not set, a file with a current-time
+    // dependent name is written in the current working directory.
+    Session &set_output_filepath(std::string s);
+
+    // The `set_max_concurrency()` method sets the maximum number of tests of
+    // the session that may be running at the same time. Zero, the default,
+    // means no limit other than not running performance tests concurrently.
+    Session &set_max_concurrency(uint32_t n);
+
+    // The `add_test()` method transfers to the session the ownership of a
+    // configured test that has not been started yet. It throws the exception
+    // `std::invalid_argument` if `MK_OPT_RESUME`, or one of the options that
+    // can only be set on the session (see above), is set for the test.
+    Session &add_test(std::unique_ptr<BaseTest> test);
+
+    // The `run()` method runs the session and blocks until it is done.
+    void run();
+
+    // The `start()` method runs the session in the background and calls the
+    // callback specified as argument when all its tests are done.
+    void start(std::function<void()> &&cb);
+
+  private:
+    class Impl;
+    mk::Safe<std::unique_ptr<Impl>> impl_;
+};
+
+} // namespace mk
+#endif